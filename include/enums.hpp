@@ -4,5 +4,6 @@
 enum BookSide {bid = 1, ask = 2};
 enum Side {buy = 1, sell = 2};
 enum OrderType {market = 1, limit = 2};
+enum WaitMode {sleep_mode = 1, spin_mode = 2};
 
 #endif
\ No newline at end of file
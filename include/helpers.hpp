@@ -6,6 +6,8 @@
 #define HELPERS_HPP
 #pragma once
 #include <random>
+#include <chrono>
+#include <cstdint>
 
 int get_random_int(int min, int max);  
 
@@ -8,6 +8,16 @@
 #include <iostream>
 
 
+// A single trade produced by matching
+struct Fill {
+    int quantity;
+    double price;
+
+    bool operator==(const Fill& other) const {
+        return quantity == other.quantity && price == other.price;
+    }
+};
+
 
 class Orderbook {
     std::map<double, std::vector<std::unique_ptr<Order>>> bids;  // Bid orders
@@ -23,11 +33,15 @@ public:
     int get_highest_bid_quantity();  // Get quantity of highest bid
     int get_lowest_ask_quantity();  // Get quantity of lowest ask
     void remove_filled_orders(int filled_quantity, double price, BookSide side);
+    std::vector<Fill> match();  // Match crossing orders, fills priced at the ask
 
 
     // Get the highest bid and lowest ask prices
     double get_highest_bid() const;
     double get_lowest_ask() const;
+
+    // Aggregated (price, total quantity) per level, best price first
+    std::vector<std::pair<double, int>> get_depth(BookSide side) const;
 };
 
 #endif // ORDERBOOK_HPP
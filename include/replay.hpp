@@ -0,0 +1,116 @@
+/**
+ * @file replay.hpp
+ * @brief Deterministic order stream replay for comparing book backends.
+ *
+ * A seeded stream of limit orders is fed into several book backends at once.
+ * After every event the fills, top of book and full depth of each backend are
+ * compared against the first (reference) backend.
+ */
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "enums.hpp"
+#include "orderbook.hpp"
+
+// A single limit order in the replayed stream
+struct ReplayEvent {
+    BookSide side;
+    int quantity;
+    double price;
+};
+
+typedef std::vector<std::pair<double, int>> Depth;  // (price, quantity), best first
+
+
+// Interface every book backend has to implement to take part in a replay
+class BookBackend {
+public:
+    virtual ~BookBackend() {}
+
+    virtual std::string name() const = 0;
+
+    // Add a limit order and append every resulting trade to fills
+    virtual void submit(const ReplayEvent& event, std::vector<Fill>& fills) = 0;
+
+    // Best prices, 0.0 when the side is empty (same convention as Orderbook)
+    virtual double best_bid() const = 0;
+    virtual double best_ask() const = 0;
+
+    virtual Depth depth(BookSide side) const = 0;
+};
+
+
+// Reference backend: the Orderbook and Orderbook::match used by main.cpp
+class OrderbookBackend : public BookBackend {
+    Orderbook ob;
+
+public:
+    std::string name() const override { return "orderbook"; }
+    void submit(const ReplayEvent& event, std::vector<Fill>& fills) override;
+    double best_bid() const override { return ob.get_highest_bid(); }
+    double best_ask() const override { return ob.get_lowest_ask(); }
+    Depth depth(BookSide side) const override { return ob.get_depth(side); }
+};
+
+
+// Port of OrderBook::match_orders from oldprogram.cpp
+class LegacyBackend : public BookBackend {
+    std::map<double, std::vector<int>> bids;  // Resting quantities per price, FIFO
+    std::map<double, std::vector<int>> asks;
+
+public:
+    std::string name() const override { return "legacy"; }
+    void submit(const ReplayEvent& event, std::vector<Fill>& fills) override;
+    double best_bid() const override;
+    double best_ask() const override;
+    Depth depth(BookSide side) const override;
+};
+
+
+// Seeded order stream. Prices and quantities follow the bot in main.cpp and
+// depend only on std::mt19937_64, so a seed gives the same stream everywhere.
+// Every sweep_check_every events the resting quantity of each side is summed;
+// a side above max_resting is swept so long soak runs keep a bounded book.
+class ReplayGenerator {
+    static const uint64_t sweep_check_every = 1024;
+
+    std::mt19937_64 gen;
+    int max_resting;
+    uint64_t count;
+    bool is_buy;
+
+public:
+    ReplayGenerator(uint64_t seed, int max_resting_);
+
+    // reference is only read to decide when to sweep
+    ReplayEvent next(const BookBackend& reference);
+};
+
+
+struct ReplayOptions {
+    uint64_t seed = 1;
+    uint64_t events = 100000;
+    int max_resting = 2000;
+    uint64_t depth_every = 1;     // Compare full depth every N events (0 = never)
+    uint64_t progress_every = 0;  // Print progress every N events (0 = never)
+};
+
+struct ReplayResult {
+    bool ok = true;
+    uint64_t events = 0;
+    uint64_t fills = 0;
+    std::string error;  // Description of the first divergence
+};
+
+
+// Replay the stream into all backends; backends[0] is the reference
+ReplayResult run_replay(const ReplayOptions& options,
+                        std::vector<std::unique_ptr<BookBackend>>& backends);
+
+#endif // REPLAY_HPP
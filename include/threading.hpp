@@ -0,0 +1,37 @@
+/**
+ * @file threading.hpp
+ * @brief Thread placement and waiting policy for the bot and user threads.
+ */
+#ifndef THREADING_HPP
+#define THREADING_HPP
+
+#include "enums.hpp"
+
+// Runtime thread settings, filled from the command line in main.cpp.
+// Both threads add orders and run matching on the shared book.
+struct ThreadConfig {
+    int bot_cpu = -1;   // Core for the bot thread, -1 = not pinned
+    int user_cpu = -1;  // Core for the user input thread, -1 = not pinned
+    WaitMode wait_mode = sleep_mode;  // How a frozen bot polls for a restart
+};
+
+// Pin the calling thread to one core. Returns false if the platform or the
+// OS refused it; the thread then keeps running unpinned.
+bool pin_current_thread(int cpu);
+
+
+// Exponential backoff for busy-poll loops: pause a growing number of times,
+// then yield the core once the limit is reached
+class Backoff {
+    int spins;
+
+public:
+    static const int max_spins = 1024;
+
+    Backoff();
+
+    void pause();  // Wait a little longer than last time
+    void reset();  // Call after useful work was done
+};
+
+#endif // THREADING_HPP
@@ -1,48 +1,53 @@
 #include "helpers.hpp"
 #include "orderbook.hpp"
+#include "threading.hpp"
 #include <iostream>
 #include <thread>
 #include <mutex>
 #include <atomic>
 #include <regex>
 #include <chrono>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 
 // Global variables
 std::atomic<bool> bot_running(true);  // Control bot behavior
 std::mutex book_mutex;  // Mutex for thread-safe operations
+ThreadConfig thread_config;  // Core pinning and wait mode, set from the command line
 
 void execute_matching_trades(Orderbook& ob) {
-    while (ob.get_highest_bid() >= ob.get_lowest_ask()) {
-        double ask_price = ob.get_lowest_ask();
-        int bid_quantity = ob.get_highest_bid_quantity();
-        int ask_quantity = ob.get_lowest_ask_quantity();
-        int fill_quantity = std::min(bid_quantity, ask_quantity);  // Fill as much as possible
+    // Start measuring time before executing the trades
+    auto start_time = std::chrono::high_resolution_clock::now();
 
-        std::cout << "\033[33mExecuting trade: " << fill_quantity << " units at $" << ask_price << "\033[0m\n";
+    std::vector<Fill> fills = ob.match();
 
-        // Start measuring time before executing the trade
-        auto start_time = std::chrono::high_resolution_clock::now();
+    // Measure the time after the trades
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
 
-        // Remove filled quantities from bids and asks
-        ob.remove_filled_orders(fill_quantity, ask_price, bid);  // Remove from bids
-        ob.remove_filled_orders(fill_quantity, ask_price, ask);  // Remove from asks
+    if (fills.empty()) return;
 
-        // Measure the time after the trade
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+    for (const Fill& fill : fills) {
+        std::cout << "\033[33mExecuting trade: " << fill.quantity << " units at $" << fill.price << "\033[0m\n";
+    }
 
-        // Print the transaction time
-        std::cout << "\033[32mTransaction time: " << duration << " nanoseconds\033[0m\n";
+    // Print the transaction time
+    std::cout << "\033[32mTransaction time: " << duration << " nanoseconds\033[0m\n";
 
-        // After execution, print the orderbook
-        ob.print();
-    }
+    // After execution, print the orderbook
+    ob.print();
 }
 
 
 
 
 void user_input(Orderbook& ob) {
+    if (thread_config.user_cpu >= 0 && !pin_current_thread(thread_config.user_cpu)) {
+        std::cout << "\033[31mCould not pin user thread to core " << thread_config.user_cpu << "\033[0m\n";
+    }
+
     while (true) {
         std::string input;
         std::cout << "Options\nPress 'i' to insert a trade, 'p' to print the order book, 'f' to freeze bot trades, 'r' to restart bot trades, 'q' to quit: ";
@@ -103,9 +108,15 @@ void user_input(Orderbook& ob) {
 // Bot behavior
 void bot_behavior(Orderbook& ob) {
     bool is_buy = true;  // Alternates between buy and sell
+    Backoff backoff;  // Used while frozen in spin mode
+
+    if (thread_config.bot_cpu >= 0 && !pin_current_thread(thread_config.bot_cpu)) {
+        std::cout << "\033[31mCould not pin bot thread to core " << thread_config.bot_cpu << "\033[0m\n";
+    }
 
     while (true) {
         if (bot_running) {
+            backoff.reset();
             std::this_thread::sleep_for(std::chrono::seconds(8));  // Adjust bot speed if needed
 
             int quantity = get_random_int(1, 2);  // Bot trades in quantities of 1 or 2
@@ -131,6 +142,8 @@ void bot_behavior(Orderbook& ob) {
             }
 
             is_buy = !is_buy;  // Alternate buy/sell after every iteration
+        } else if (thread_config.wait_mode == spin_mode) {
+            backoff.pause();  // Busy-poll for a restart without giving up the core
         } else {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));  // Short pause when bot is frozen
         }
@@ -138,7 +151,36 @@ void bot_behavior(Orderbook& ob) {
 }
 
 
-int main() {
+// Parse a core number for --bot-cpu / --user-cpu; rejects junk and negatives
+bool parse_cpu(const char* text, int& cpu) {
+    char* end = nullptr;
+    errno = 0;
+    long value = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || value < 0 || value > INT_MAX) {
+        return false;
+    }
+    cpu = static_cast<int>(value);
+    return true;
+}
+
+
+int main(int argc, char** argv) {
+    // Optional thread placement: --bot-cpu N, --user-cpu N, --spin
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bot-cpu") == 0 && i + 1 < argc &&
+            parse_cpu(argv[i + 1], thread_config.bot_cpu)) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--user-cpu") == 0 && i + 1 < argc &&
+                   parse_cpu(argv[i + 1], thread_config.user_cpu)) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--spin") == 0) {
+            thread_config.wait_mode = spin_mode;
+        } else {
+            std::cout << "Usage: main [--bot-cpu N] [--user-cpu N] [--spin]\n";
+            return 1;
+        }
+    }
+
     Orderbook ob;
 
     // Initialize the order book with random bids and asks
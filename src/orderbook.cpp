@@ -5,6 +5,7 @@
 #include <regex>
 #include "helpers.hpp"
 #include <iostream>  // Required for std::cout
+#include <algorithm>
 
 
 
@@ -143,3 +144,47 @@ void Orderbook::remove_filled_orders(int filled_quantity, double price, BookSide
         }
     }
 }
+
+
+// Get the aggregated quantity at each price level, best price first
+std::vector<std::pair<double, int>> Orderbook::get_depth(BookSide side) const {
+    std::vector<std::pair<double, int>> levels;
+
+    auto add_level = [&levels](double price, const std::vector<std::unique_ptr<Order>>& orders) {
+        int total_quantity = 0;
+        for (const auto& order : orders) {
+            total_quantity += order->get_quantity();
+        }
+        levels.emplace_back(price, total_quantity);
+    };
+
+    if (side == bid) {
+        for (auto it = bids.rbegin(); it != bids.rend(); ++it) {
+            add_level(it->first, it->second);  // Highest bid first
+        }
+    } else if (side == ask) {
+        for (auto it = asks.begin(); it != asks.end(); ++it) {
+            add_level(it->first, it->second);  // Lowest ask first
+        }
+    }
+    return levels;
+}
+
+
+// Match the highest bid against the lowest ask until the book no longer crosses
+std::vector<Fill> Orderbook::match() {
+    std::vector<Fill> fills;
+
+    // Both sides must be non-empty: an empty side reports a price of 0.0
+    while (!bids.empty() && !asks.empty() && get_highest_bid() >= get_lowest_ask()) {
+        double ask_price = get_lowest_ask();
+        int fill_quantity = std::min(get_highest_bid_quantity(), get_lowest_ask_quantity());  // Fill as much as possible
+
+        // Remove filled quantities from bids and asks
+        remove_filled_orders(fill_quantity, ask_price, bid);
+        remove_filled_orders(fill_quantity, ask_price, ask);
+
+        fills.push_back(Fill{fill_quantity, ask_price});
+    }
+    return fills;
+}
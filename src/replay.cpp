@@ -0,0 +1,224 @@
+#include "replay.hpp"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+
+void OrderbookBackend::submit(const ReplayEvent& event, std::vector<Fill>& fills) {
+    ob.add_order(event.quantity, event.price, event.side);
+
+    std::vector<Fill> matched = ob.match();
+    fills.insert(fills.end(), matched.begin(), matched.end());
+}
+
+
+void LegacyBackend::submit(const ReplayEvent& event, std::vector<Fill>& fills) {
+    if (event.quantity <= 0) return;
+
+    if (event.side == bid) {
+        bids[event.price].push_back(event.quantity);
+    } else {
+        asks[event.price].push_back(event.quantity);
+    }
+
+    while (!bids.empty() && !asks.empty()) {
+        auto highest_bid = --bids.end();
+        auto lowest_ask = asks.begin();
+
+        if (highest_bid->first < lowest_ask->first) {
+            break;  // No match is possible
+        }
+
+        int quantity = std::min(highest_bid->second[0], lowest_ask->second[0]);
+        fills.push_back(Fill{quantity, lowest_ask->first});  // Fill price is always the ask price
+
+        highest_bid->second[0] -= quantity;
+        lowest_ask->second[0] -= quantity;
+
+        if (highest_bid->second[0] == 0) {
+            highest_bid->second.erase(highest_bid->second.begin());
+            if (highest_bid->second.empty()) {
+                bids.erase(highest_bid);
+            }
+        }
+
+        if (lowest_ask->second[0] == 0) {
+            lowest_ask->second.erase(lowest_ask->second.begin());
+            if (lowest_ask->second.empty()) {
+                asks.erase(lowest_ask);
+            }
+        }
+    }
+}
+
+double LegacyBackend::best_bid() const {
+    return bids.empty() ? 0.0 : bids.rbegin()->first;
+}
+
+double LegacyBackend::best_ask() const {
+    return asks.empty() ? 0.0 : asks.begin()->first;
+}
+
+Depth LegacyBackend::depth(BookSide side) const {
+    Depth levels;
+    auto add_level = [&levels](double price, const std::vector<int>& quantities) {
+        int total_quantity = 0;
+        for (int qty : quantities) {
+            total_quantity += qty;
+        }
+        levels.emplace_back(price, total_quantity);
+    };
+
+    if (side == bid) {
+        for (auto it = bids.rbegin(); it != bids.rend(); ++it) {
+            add_level(it->first, it->second);
+        }
+    } else {
+        for (auto it = asks.begin(); it != asks.end(); ++it) {
+            add_level(it->first, it->second);
+        }
+    }
+    return levels;
+}
+
+
+ReplayGenerator::ReplayGenerator(uint64_t seed, int max_resting_)
+    : gen(seed), max_resting(max_resting_), count(0), is_buy(true) {}
+
+ReplayEvent ReplayGenerator::next(const BookBackend& reference) {
+    // Sweep a side that grew too large so the book stays bounded
+    if (max_resting > 0 && count++ % sweep_check_every == 0) {
+        for (BookSide side : {bid, ask}) {
+            int resting = 0;
+            for (const auto& level : reference.depth(side)) {
+                resting += level.second;
+            }
+            if (resting > max_resting) {
+                if (side == bid) {
+                    return ReplayEvent{ask, resting, 90.0};
+                }
+                return ReplayEvent{bid, resting, 110.0};
+            }
+        }
+    }
+
+    // Bot behavior from main.cpp: alternate sides, 1-2 units, overlapping ranges.
+    // Values are mapped from gen() directly; std::uniform_int_distribution
+    // differs between standard libraries and would break replay across toolchains.
+    ReplayEvent event;
+    event.quantity = static_cast<int>(1 + gen() % 2);
+    if (is_buy) {
+        event.side = bid;
+        event.price = static_cast<double>(90 + gen() % 16);  // 90..105
+    } else {
+        event.side = ask;
+        event.price = static_cast<double>(95 + gen() % 16);  // 95..110
+    }
+    is_buy = !is_buy;
+    return event;
+}
+
+
+namespace {
+
+std::string describe(const ReplayEvent& event) {
+    std::ostringstream out;
+    out << event.quantity << ((event.side == bid) ? "b " : "s ") << event.price;
+    return out.str();
+}
+
+std::string describe(const std::vector<Fill>& fills) {
+    std::ostringstream out;
+    out << "[";
+    for (size_t i = 0; i < fills.size(); ++i) {
+        out << (i ? ", " : "") << fills[i].quantity << "@" << fills[i].price;
+    }
+    out << "]";
+    return out.str();
+}
+
+std::string describe(const Depth& levels) {
+    std::ostringstream out;
+    out << "[";
+    for (size_t i = 0; i < levels.size(); ++i) {
+        out << (i ? ", " : "") << levels[i].first << ":" << levels[i].second;
+    }
+    out << "]";
+    return out.str();
+}
+
+std::string divergence(const ReplayOptions& options, uint64_t index, const ReplayEvent& event,
+                       const BookBackend& backend, const std::string& what,
+                       const std::string& expected, const std::string& actual) {
+    std::ostringstream out;
+    out << "seed " << options.seed << ", event " << index << " (" << describe(event) << "): "
+        << backend.name() << " " << what << " " << actual << ", expected " << expected;
+    return out.str();
+}
+
+}  // namespace
+
+
+ReplayResult run_replay(const ReplayOptions& options,
+                        std::vector<std::unique_ptr<BookBackend>>& backends) {
+    ReplayResult result;
+    if (backends.empty()) return result;
+
+    ReplayGenerator generator(options.seed, options.max_resting);
+    const BookBackend& reference = *backends[0];
+    std::vector<Fill> expected_fills;
+    std::vector<Fill> fills;
+
+    for (uint64_t i = 0; i < options.events; ++i) {
+        ReplayEvent event = generator.next(reference);
+
+        expected_fills.clear();
+        backends[0]->submit(event, expected_fills);
+        result.fills += expected_fills.size();
+
+        bool check_depth = options.depth_every && (i + 1) % options.depth_every == 0;
+
+        for (size_t b = 1; b < backends.size(); ++b) {
+            BookBackend& backend = *backends[b];
+            fills.clear();
+            backend.submit(event, fills);
+
+            if (fills != expected_fills) {
+                result.error = divergence(options, i, event, backend, "filled",
+                                          describe(expected_fills), describe(fills));
+            } else if (backend.best_bid() != reference.best_bid()) {
+                result.error = divergence(options, i, event, backend, "best bid",
+                                          std::to_string(reference.best_bid()),
+                                          std::to_string(backend.best_bid()));
+            } else if (backend.best_ask() != reference.best_ask()) {
+                result.error = divergence(options, i, event, backend, "best ask",
+                                          std::to_string(reference.best_ask()),
+                                          std::to_string(backend.best_ask()));
+            } else if (check_depth) {
+                for (BookSide side : {bid, ask}) {
+                    Depth expected = reference.depth(side);
+                    Depth actual = backend.depth(side);
+                    if (actual != expected) {
+                        result.error = divergence(options, i, event, backend,
+                                                  (side == bid) ? "bid depth" : "ask depth",
+                                                  describe(expected), describe(actual));
+                        break;
+                    }
+                }
+            }
+
+            if (!result.error.empty()) {
+                result.ok = false;
+                result.events = i + 1;
+                return result;
+            }
+        }
+
+        if (options.progress_every && (i + 1) % options.progress_every == 0) {
+            std::cout << "Replayed " << (i + 1) << " events, " << result.fills << " fills\n";
+        }
+    }
+
+    result.events = options.events;
+    return result;
+}
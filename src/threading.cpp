@@ -0,0 +1,49 @@
+#include "threading.hpp"
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+// CPU hint that we are in a spin loop
+static inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+
+bool pin_current_thread(int cpu) {
+    if (cpu < 0) return false;
+
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;  // No hard affinity API (e.g. macOS)
+#endif
+}
+
+
+Backoff::Backoff() : spins(1) {}
+
+void Backoff::pause() {
+    if (spins < max_spins) {
+        for (int i = 0; i < spins; ++i) {
+            cpu_relax();
+        }
+        spins *= 2;
+    } else {
+        std::this_thread::yield();  // Let other threads on this core run
+    }
+}
+
+void Backoff::reset() {
+    spins = 1;
+}